@@ -569,6 +569,362 @@ bool BQ77307::readAndDecodeREGOUTControl()
 	return true;
 }
 
+BQ77307Encoder::BQ77307Encoder(Print& out, Format format)
+	: _out(out), _format(format), _length(0), _needComma(false)
+{
+}
+
+// Start an anonymous object (the top level document)
+void BQ77307Encoder::beginObject()
+{
+	if (_format == CBOR) {
+		putByte(0xBF); // Indefinite-length map, so field counts need not be known up front
+		return;
+	}
+	putSeparator();
+	putByte('{');
+	_needComma = false;
+}
+
+// Start a nested object stored under key
+void BQ77307Encoder::beginObject(const __FlashStringHelper* key)
+{
+	putKey(key);
+	if (_format == CBOR) {
+		putByte(0xBF);
+		return;
+	}
+	putByte('{');
+	_needComma = false;
+}
+
+void BQ77307Encoder::endObject()
+{
+	putByte(_format == CBOR ? 0xFF : '}'); // 0xFF is the CBOR "break" byte
+	_needComma = true;
+}
+
+void BQ77307Encoder::writeBool(const __FlashStringHelper* key, bool value)
+{
+	putKey(key);
+	if (_format == CBOR) {
+		putByte(value ? 0xF5 : 0xF4);
+	}
+	else {
+		putString(value ? F("true") : F("false"));
+	}
+	_needComma = true;
+}
+
+void BQ77307Encoder::writeUInt(const __FlashStringHelper* key, unsigned long value)
+{
+	putKey(key);
+	if (_format == CBOR) {
+		putCborHeader(0, value); // Major type 0: unsigned integer
+	}
+	else {
+		putDecimal(value);
+	}
+	_needComma = true;
+}
+
+void BQ77307Encoder::writeText(const __FlashStringHelper* key, const __FlashStringHelper* value)
+{
+	putKey(key);
+	if (_format == CBOR) {
+		putCborHeader(3, strlen_P(reinterpret_cast<PGM_P>(value))); // Major type 3: text string
+		putString(value);
+	}
+	else {
+		putByte('"');
+		putString(value); // Values are fixed identifiers, so no escaping is needed
+		putByte('"');
+	}
+	_needComma = true;
+}
+
+void BQ77307Encoder::writeNull(const __FlashStringHelper* key)
+{
+	putKey(key);
+	if (_format == CBOR) {
+		putByte(0xF6);
+	}
+	else {
+		putString(F("null"));
+	}
+	_needComma = true;
+}
+
+// Hand any staged bytes to the Print
+void BQ77307Encoder::flush()
+{
+	if (_length == 0) return;
+	_out.write(_scratch, _length);
+	_length = 0;
+}
+
+void BQ77307Encoder::putKey(const __FlashStringHelper* key)
+{
+	if (_format == CBOR) {
+		putCborHeader(3, strlen_P(reinterpret_cast<PGM_P>(key)));
+		putString(key);
+		return;
+	}
+	putSeparator();
+	putByte('"');
+	putString(key);
+	putByte('"');
+	putByte(':');
+}
+
+void BQ77307Encoder::putSeparator()
+{
+	if (_needComma) putByte(',');
+}
+
+void BQ77307Encoder::putByte(byte value)
+{
+	if (_length == SCRATCH_LENGTH) flush();
+	_scratch[_length++] = value;
+}
+
+void BQ77307Encoder::putString(const __FlashStringHelper* str)
+{
+	PGM_P p = reinterpret_cast<PGM_P>(str);
+	for (char c = pgm_read_byte(p); c != 0; c = pgm_read_byte(++p)) {
+		putByte(c);
+	}
+}
+
+// Writes the initial byte (and any following length bytes) of a CBOR data item
+void BQ77307Encoder::putCborHeader(byte majorType, unsigned long value)
+{
+	majorType <<= 5;
+	if (value < 24) {
+		putByte(majorType | value);
+	}
+	else if (value <= 0xFF) {
+		putByte(majorType | 24);
+		putByte(value);
+	}
+	else if (value <= 0xFFFF) {
+		putByte(majorType | 25);
+		putByte(value >> 8);
+		putByte(value);
+	}
+	else {
+		putByte(majorType | 26);
+		putByte(value >> 24);
+		putByte(value >> 16);
+		putByte(value >> 8);
+		putByte(value);
+	}
+}
+
+void BQ77307Encoder::putDecimal(unsigned long value)
+{
+	char digits[10]; // Enough for the largest 32-bit value
+	byte count = 0;
+	do {
+		digits[count++] = '0' + (value % 10);
+		value /= 10;
+	} while (value != 0);
+	while (count > 0) {
+		putByte(digits[--count]);
+	}
+}
+
+// Function to read every decoded register and stream it to out as one JSON object
+// (terminated by a newline) or one CBOR map. Registers that fail to read are encoded as null.
+// returns true if every register was read successfully
+bool BQ77307::writeRegisters(Print& out, BQ77307Encoder::Format format)
+{
+	BQ77307Encoder enc(out, format);
+	bool ok = true;
+
+	enc.beginObject();
+	ok &= encodeSafetyA(enc, F("safetyAlertA"), 0x02, false);
+	ok &= encodeSafetyA(enc, F("safetyFaultA"), 0x03, true);
+	ok &= encodeSafetyB(enc, F("safetyAlertB"), 0x04);
+	ok &= encodeSafetyB(enc, F("safetyFaultB"), 0x05);
+	ok &= encodeBatteryStatus(enc);
+	ok &= encodeAlarmStatus(enc, F("alarmStatus"), 0x62);
+	ok &= encodeAlarmStatus(enc, F("alarmStatusRaw"), 0x64);
+	ok &= encodeAlarmStatus(enc, F("alarmStatusEnabled"), 0x66);
+	ok &= encodeFetControl(enc);
+	ok &= encodeREGOUTControl(enc);
+	enc.endObject();
+	enc.flush();
+
+	if (format == BQ77307Encoder::JSON) out.println();
+	return ok;
+}
+
+// Safety Alert A (0x02) and Safety Status A (0x03) share their layout, except that
+// bits 1 and 0 are reserved in the alert register
+bool BQ77307::encodeSafetyA(BQ77307Encoder& enc, const __FlashStringHelper* key, byte regAddress, bool fault)
+{
+	int value = readRegister(regAddress);
+	if (value == -1)
+	{
+		enc.writeNull(key);
+		return false;
+	}
+
+	enc.beginObject(key);
+	enc.writeUInt(F("raw"), value);
+	enc.writeBool(F("COV"), (value & (1 << 7)) != 0);
+	enc.writeBool(F("CUV"), (value & (1 << 6)) != 0);
+	enc.writeBool(F("SCD"), (value & (1 << 5)) != 0);
+	enc.writeBool(F("OCD1"), (value & (1 << 4)) != 0);
+	enc.writeBool(F("OCD2"), (value & (1 << 3)) != 0);
+	enc.writeBool(F("OCC"), (value & (1 << 2)) != 0);
+	if (fault)
+	{
+		enc.writeBool(F("CURLATCH"), (value & (1 << 1)) != 0);
+		enc.writeBool(F("REGOUT"), (value & (1 << 0)) != 0);
+	}
+	enc.endObject();
+	return true;
+}
+
+// Safety Alert B (0x04) and Safety Status B (0x05) share their layout
+bool BQ77307::encodeSafetyB(BQ77307Encoder& enc, const __FlashStringHelper* key, byte regAddress)
+{
+	int value = readRegister(regAddress);
+	if (value == -1)
+	{
+		enc.writeNull(key);
+		return false;
+	}
+
+	enc.beginObject(key);
+	enc.writeUInt(F("raw"), value);
+	enc.writeBool(F("OTD"), (value & (1 << 7)) != 0);
+	enc.writeBool(F("OTC"), (value & (1 << 6)) != 0);
+	enc.writeBool(F("UTD"), (value & (1 << 5)) != 0);
+	enc.writeBool(F("UTC"), (value & (1 << 4)) != 0);
+	enc.writeBool(F("OTINT"), (value & (1 << 3)) != 0);
+	// Bit 2 is reserved
+	enc.writeBool(F("VREF"), (value & (1 << 1)) != 0);
+	enc.writeBool(F("VSS"), (value & (1 << 0)) != 0);
+	enc.endObject();
+	return true;
+}
+
+// Battery Status (0x12), decoded the same way as readAndDecodeBatteryStatus()
+bool BQ77307::encodeBatteryStatus(BQ77307Encoder& enc)
+{
+	int batteryStatus = readRegister(0x12, 2);
+	if (batteryStatus == -1)
+	{
+		enc.writeNull(F("batteryStatus"));
+		return false;
+	}
+
+	bool deviceNormalMode    = (batteryStatus & (1 << 15)) != 0;
+	bool deviceConfigureMode = (batteryStatus & (1 << 5)) != 0;
+	int deviceSecurity       = (batteryStatus >> 10) & 0x03;
+
+	enc.beginObject(F("batteryStatus"));
+	enc.writeUInt(F("raw"), (unsigned int)batteryStatus);
+	if (!deviceNormalMode) enc.writeText(F("mode"), F("Shutdown"));
+	else if (deviceConfigureMode) enc.writeText(F("mode"), F("Configure"));
+	else enc.writeText(F("mode"), F("Normal"));
+
+	if (deviceSecurity == 0) enc.writeText(F("security"), F("Uninitialized"));
+	else if (deviceSecurity == 1) enc.writeText(F("security"), F("FullAccess"));
+	else if (deviceSecurity == 2) enc.writeText(F("security"), F("Error"));
+	else enc.writeText(F("security"), F("Sealed"));
+
+	enc.writeBool(F("NORMAL"), deviceNormalMode);
+	enc.writeBool(F("SA"), (batteryStatus & (1 << 13)) != 0);
+	enc.writeBool(F("SS"), (batteryStatus & (1 << 12)) != 0);
+	enc.writeBool(F("FET_EN"), (batteryStatus & (1 << 8)) != 0);
+	enc.writeBool(F("POR"), (batteryStatus & (1 << 7)) != 0);
+	enc.writeBool(F("CFGUPDATE"), deviceConfigureMode);
+	enc.writeBool(F("ALERTPIN"), (batteryStatus & (1 << 4)) != 0);
+	enc.writeBool(F("CHG"), (batteryStatus & (1 << 3)) != 0);
+	enc.writeBool(F("DSG"), (batteryStatus & (1 << 2)) != 0);
+	enc.writeBool(F("CHGDETFLAG"), (batteryStatus & (1 << 1)) != 0);
+	enc.endObject();
+	return true;
+}
+
+// Alarm Status (0x62), Alarm Raw Status (0x64) and Alarm Enable (0x66) share their layout
+bool BQ77307::encodeAlarmStatus(BQ77307Encoder& enc, const __FlashStringHelper* key, byte regAddress)
+{
+	int alarmStatus = readRegister(regAddress, 2);
+	if (alarmStatus == -1)
+	{
+		enc.writeNull(key);
+		return false;
+	}
+
+	enc.beginObject(key);
+	enc.writeUInt(F("raw"), (unsigned int)alarmStatus);
+	enc.writeBool(F("SSA"), (alarmStatus & (1 << 15)) != 0);
+	enc.writeBool(F("SSB"), (alarmStatus & (1 << 14)) != 0);
+	enc.writeBool(F("SAA"), (alarmStatus & (1 << 13)) != 0);
+	enc.writeBool(F("SAB"), (alarmStatus & (1 << 12)) != 0);
+	enc.writeBool(F("XCHG"), (alarmStatus & (1 << 11)) != 0);
+	enc.writeBool(F("XDSG"), (alarmStatus & (1 << 10)) != 0);
+	enc.writeBool(F("SHUTV"), (alarmStatus & (1 << 9)) != 0);
+	enc.writeBool(F("CHECK1"), (alarmStatus & (1 << 7)) != 0);
+	enc.writeBool(F("CHECK2"), (alarmStatus & (1 << 6)) != 0);
+	enc.writeBool(F("INITCOMP"), (alarmStatus & (1 << 2)) != 0);
+	enc.writeBool(F("CDTOGGLE"), (alarmStatus & (1 << 1)) != 0);
+	enc.writeBool(F("POR"), (alarmStatus & (1 << 0)) != 0);
+	enc.endObject();
+	return true;
+}
+
+// Fet Control Status (0x68)
+bool BQ77307::encodeFetControl(BQ77307Encoder& enc)
+{
+	int fetControl = readRegister(0x68);
+	if (fetControl == -1)
+	{
+		enc.writeNull(F("fetControl"));
+		return false;
+	}
+
+	enc.beginObject(F("fetControl"));
+	enc.writeUInt(F("raw"), fetControl);
+	enc.writeBool(F("CHG_OFF"), (fetControl & (1 << 3)) != 0);
+	enc.writeBool(F("DSG_OFF"), (fetControl & (1 << 2)) != 0);
+	enc.writeBool(F("CHG_ON"), (fetControl & (1 << 1)) != 0);
+	enc.writeBool(F("DSG_ON"), (fetControl & (1 << 0)) != 0);
+	enc.endObject();
+	return true;
+}
+
+// REGOUT Control Status (0x69). The voltage is reported in millivolts to avoid float formatting.
+bool BQ77307::encodeREGOUTControl(BQ77307Encoder& enc)
+{
+	int regoutControl = readRegister(0x69);
+	if (regoutControl == -1)
+	{
+		enc.writeNull(F("regoutControl"));
+		return false;
+	}
+
+	int REGOUT_VOLTAGE_MODE = (regoutControl & 0x07);
+	unsigned int millivolts = 1800; // Modes 0 through 3
+	if (REGOUT_VOLTAGE_MODE == 4) millivolts = 2500;
+	else if (REGOUT_VOLTAGE_MODE == 5) millivolts = 3000;
+	else if (REGOUT_VOLTAGE_MODE == 6) millivolts = 3300;
+	else if (REGOUT_VOLTAGE_MODE == 7) millivolts = 5000;
+
+	enc.beginObject(F("regoutControl"));
+	enc.writeUInt(F("raw"), regoutControl);
+	enc.writeBool(F("TS_ON"), (regoutControl & (1 << 4)) != 0);
+	enc.writeBool(F("REG_EN"), (regoutControl & (1 << 3)) != 0);
+	enc.writeUInt(F("REGOUT_mV"), millivolts);
+	enc.endObject();
+	return true;
+}
+
 // This command is sent to reset the device
 void BQ77307::Reset() {
 	sendCommand(0x0012);
@@ -4,6 +4,41 @@
 #include <Arduino.h>
 #include <Wire.h>
 
+// Streaming JSON/CBOR encoder used by BQ77307::writeRegisters().
+// Output is staged in a fixed scratch buffer and handed to the Print in chunks,
+// so encoding never touches the heap. Keys and text values live in flash (F()).
+class BQ77307Encoder {
+public:
+    enum Format { JSON, CBOR };
+
+    BQ77307Encoder(Print& out, Format format);
+
+    void beginObject();
+    void beginObject(const __FlashStringHelper* key);
+    void endObject();
+    void writeBool(const __FlashStringHelper* key, bool value);
+    void writeUInt(const __FlashStringHelper* key, unsigned long value);
+    void writeText(const __FlashStringHelper* key, const __FlashStringHelper* value);
+    void writeNull(const __FlashStringHelper* key);
+    void flush();
+
+private:
+    void putKey(const __FlashStringHelper* key);
+    void putSeparator();
+    void putByte(byte value);
+    void putString(const __FlashStringHelper* str);
+    void putCborHeader(byte majorType, unsigned long value);
+    void putDecimal(unsigned long value);
+
+    static const byte SCRATCH_LENGTH = 32;
+
+    Print& _out;
+    Format _format;
+    byte _scratch[SCRATCH_LENGTH];
+    byte _length;
+    bool _needComma;
+};
+
 class BQ77307 {
 public:
     BQ77307();
@@ -20,6 +55,7 @@ public:
     bool readAndDecodeAlarmStatusEnabled();
     bool readAndDecodeFetControl();
     bool readAndDecodeREGOUTControl();
+    bool writeRegisters(Print& out, BQ77307Encoder::Format format = BQ77307Encoder::JSON);
     void Reset();
     void Toggle_FET_Control();
     void Seal_Configuration();
@@ -35,6 +71,12 @@ private:
     int readRegisterWithoutCRC(byte regAddress, byte numBytes = 1, unsigned long timeout = 1000);
     int readRegisterWithCRC(byte regAddress, byte numBytes = 1, unsigned long timeout = 1000);
     void writeRegisterWithoutCRC(byte regAddress, byte value);
+    bool encodeSafetyA(BQ77307Encoder& enc, const __FlashStringHelper* key, byte regAddress, bool fault);
+    bool encodeSafetyB(BQ77307Encoder& enc, const __FlashStringHelper* key, byte regAddress);
+    bool encodeBatteryStatus(BQ77307Encoder& enc);
+    bool encodeAlarmStatus(BQ77307Encoder& enc, const __FlashStringHelper* key, byte regAddress);
+    bool encodeFetControl(BQ77307Encoder& enc);
+    bool encodeREGOUTControl(BQ77307Encoder& enc);
 
     const byte _bq77307Address = 0x08;
     const int I2C_BUFFER_LENGTH = 32;
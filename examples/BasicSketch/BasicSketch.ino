@@ -16,6 +16,10 @@ void setup() {
   Serial.println("BQ77307 status:");
   bq77307.readAndDecodeAlarmStatus();
   bq77307.readAndDecodeREGOUTControl()
+
+  // Machine-readable output: every decoded register as one line of JSON.
+  // Pass BQ77307Encoder::CBOR instead for a compact binary stream.
+  bq77307.writeRegisters(Serial);
 }
 
 void loop() {